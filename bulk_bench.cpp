@@ -0,0 +1,101 @@
+// Bulk formatting of large arrays of SystemC values.
+//
+// For sc_uint<32>, sc_int<64>, sc_lv<64> and sc_biguint<128> arrays, compares
+//   + a loop of fmt::format() calls appended to a std::string
+//   + sc_format::format_range() with 1 thread and with the requested threads
+//   + sc_format::write_range() streaming to /dev/null
+// and checks that the bulk output matches the loop byte for byte.
+//
+// sc_uint, sc_int and sc_lv ('l') run in parallel (see sc_format_bulk.hpp).
+// sc_biguint is not safe to format concurrently, so its "parallel" column
+// runs on one thread and shows the saving from a single output buffer only.
+// write_range() output is verified by bulk_test.cpp.
+//
+// Usage: bulk_bench [elements [threads]]
+
+#include <systemc>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include "sc_format.hpp"
+#include "sc_format_bulk.hpp"
+
+namespace {
+
+template< typename Fn >
+auto seconds( Fn&& fn ) -> double
+{
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+}
+
+template< typename T >
+auto bench( const char* name, fmt::format_string<const T&> spec, std::size_t count, unsigned threads, int null_fd ) -> bool
+{
+  std::vector<T> values( count );
+  sc_dt::uint64 x = 0x9e3779b97f4a7c15ULL;
+  for( auto& v : values ) {
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17; // xorshift
+    v = x;
+  }
+
+  std::string looped;
+  auto t_loop = seconds( [&]{
+    for( auto const& v : values ) looped += fmt::format( spec, v );
+  } );
+  fmt::memory_buffer serial, parallel;
+  auto t_serial = seconds( [&]{
+    sc_format::format_range( serial, spec, values, { 1 } );
+  } );
+  auto t_parallel = seconds( [&]{
+    sc_format::format_range( parallel, spec, values, { threads } );
+  } );
+  auto t_stream = seconds( [&]{
+    sc_format::write_range( null_fd, spec, values, { threads } );
+  } );
+
+  auto same = std::string_view( serial.data(), serial.size() ) == looped
+           && std::string_view( parallel.data(), parallel.size() ) == looped;
+  auto rate = [&]( double s ) { return count / s; };
+  fmt::print( "{:<16} {:>14.0f} {:>14.0f} {:>14.0f} {:>14.0f} {:>8.2f}x {}\n",
+              name, rate( t_loop ), rate( t_serial ), rate( t_parallel ), rate( t_stream ),
+              t_loop / t_parallel, same ? "ok" : "MISMATCH" );
+  return same;
+}
+
+}//end namespace
+
+[[maybe_unused]]
+int sc_main( int argc, char* argv[] )
+{
+  std::size_t count   = ( argc > 1 ) ? std::strtoull( argv[1], nullptr, 0 ) : 1'000'000;
+  unsigned    threads = ( argc > 2 ) ? unsigned( std::strtoul( argv[2], nullptr, 0 ) ) : std::thread::hardware_concurrency();
+  int null_fd = ::open( "/dev/null", O_WRONLY );
+  if( null_fd < 0 ) {
+    fmt::print( "Unable to open /dev/null\n" );
+    return EXIT_FAILURE;
+  }
+
+  fmt::print( "{} elements, {} threads (elements/s)\n", count, threads );
+  fmt::print( "{:<16} {:>14} {:>14} {:>14} {:>14} {:>9}\n", "type", "fmt::format", "bulk 1 thread", "bulk parallel", "stream", "speedup" );
+  bool ok = true;
+  ok &= bench<sc_dt::sc_uint<32>>(     "sc_uint<32>",     "{:x}\n", count, threads, null_fd );
+  ok &= bench<sc_dt::sc_int<64>>(      "sc_int<64>",      "{:x}\n", count, threads, null_fd );
+  ok &= bench<sc_dt::sc_lv<64>>(       "sc_lv<64>",       "{}\n",   count, threads, null_fd );
+  ok &= bench<sc_dt::sc_biguint<128>>( "sc_biguint<128>", "{:x}\n", count, threads, null_fd );
+  ::close( null_fd );
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// TAGS: Doulos, Systemc, format, bulk, benchmark, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
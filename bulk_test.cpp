@@ -0,0 +1,182 @@
+// Checks that sc_format::format_range() and sc_format::write_range() produce
+// exactly the output of a simple fmt::format loop, on the parallel path
+// (native integers, sc_int, sc_uint and sc_lv over several threads and
+// rounds) and on the serial path that sc_biguint is restricted to.
+// write_range() output is read back from a temporary file and compared byte
+// for byte.
+//
+// The parallel sc_int/sc_uint path relies on the native rendering in
+// sc_format.hpp, so that is first checked against SystemC's to_string() for
+// every d/b/o/x, u/m and p combination over a range of widths and values.
+
+#include <systemc>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "sc_format.hpp"
+#include "sc_format_bulk.hpp"
+
+static_assert( sc_format::bulk_parallel_safe_v<std::uint32_t> );
+static_assert( sc_format::bulk_parallel_safe_v<sc_dt::sc_int<32>> );
+static_assert( sc_format::bulk_parallel_safe_v<sc_dt::sc_uint<32>> );
+static_assert( sc_format::bulk_parallel_safe_v<sc_dt::sc_lv<64>> );
+static_assert( !sc_format::bulk_parallel_safe_v<sc_dt::sc_bigint<128>> );
+static_assert( !sc_format::bulk_parallel_safe_v<sc_dt::sc_biguint<128>> );
+static_assert( !sc_format::bulk_parallel_safe_v<sc_core::sc_time> );
+
+namespace {
+int failures = 0;
+
+//------------------------------------------------------------------------------
+// Native sc_int/sc_uint rendering vs to_string()
+
+std::vector<std::int64_t> sample_values()
+{
+  std::vector<std::int64_t> values{ 0, 1, -1, 2, -2, 5, -5, 7, 8, -8, 0x7f, -0x80, 0xff, 0x100,
+                                    std::numeric_limits<std::int64_t>::max(),
+                                    std::numeric_limits<std::int64_t>::min() };
+  std::uint64_t x = 0x9e3779b97f4a7c15ULL;
+  for ( int i = 0; i < 64; ++i ) {
+    x ^= x << 13; x ^= x >> 7; x ^= x << 17; // xorshift
+    values.push_back( static_cast<std::int64_t>( x >> ( i % 64 ) ) ); // All magnitudes
+  }
+  return values;
+}
+
+template< typename T >
+void check_native( const char* name )
+{
+  using namespace sc_dt;
+  struct Case { const char* spec; sc_numrep numrep; bool prefix; };
+  static const Case cases[] = {
+    { "{:d}",   SC_DEC,    false }, { "{:pd}",   SC_DEC,    true },
+    { "{:ud}",  SC_DEC,    false }, { "{:mpd}",  SC_DEC,    true },
+    { "{:b}",   SC_BIN,    false }, { "{:pb}",   SC_BIN,    true },
+    { "{:ub}",  SC_BIN_US, false }, { "{:upb}",  SC_BIN_US, true },
+    { "{:mb}",  SC_BIN_SM, false }, { "{:mpb}",  SC_BIN_SM, true },
+    { "{:o}",   SC_OCT,    false }, { "{:po}",   SC_OCT,    true },
+    { "{:uo}",  SC_OCT_US, false }, { "{:upo}",  SC_OCT_US, true },
+    { "{:mo}",  SC_OCT_SM, false }, { "{:mpo}",  SC_OCT_SM, true },
+    { "{:x}",   SC_HEX,    false }, { "{:px}",   SC_HEX,    true },
+    { "{:ux}",  SC_HEX_US, false }, { "{:upx}",  SC_HEX_US, true },
+    { "{:mx}",  SC_HEX_SM, false }, { "{:mpx}",  SC_HEX_SM, true },
+  };
+  for ( auto raw : sample_values() ) {
+    T value;
+    value = raw; // Truncated to W bits
+    for ( auto const& c : cases ) {
+      auto native   = fmt::format( fmt::runtime( c.spec ), value );
+      auto systemc  = std::string( value.to_string( c.numrep, c.prefix ) );
+      if ( native != systemc ) {
+        fmt::print( "FAILED: {} {} of {:#x}: \"{}\" != to_string() \"{}\"\n", name, c.spec, raw, native, systemc );
+        ++failures;
+        return;
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+// Bulk output vs a fmt::format loop
+
+template< typename T >
+auto looped( fmt::format_string<const T&> spec, std::vector<T> const& values ) -> std::string
+{
+  std::string result;
+  for ( auto const& v : values ) { result += fmt::format( spec, v ); }
+  return result;
+}
+
+template< typename T >
+auto streamed( fmt::format_string<const T&> spec, std::vector<T> const& values, sc_format::BulkOptions const& options ) -> std::string
+{
+  std::FILE* file = std::tmpfile();
+  if ( file == nullptr ) { return "<tmpfile failed>"; }
+  sc_format::write_range( fileno( file ), spec, values, options );
+  std::rewind( file );
+  std::string result;
+  char chunk[65536];
+  for ( std::size_t n; ( n = std::fread( chunk, 1, sizeof( chunk ), file ) ) > 0; ) { result.append( chunk, n ); }
+  std::fclose( file );
+  return result;
+}
+
+template< typename T >
+void check( const char* name, std::vector<T> const& values, fmt::format_string<const T&> spec, sc_format::BulkOptions const& options )
+{
+  auto expected = looped( spec, values );
+  fmt::memory_buffer buffer;
+  sc_format::format_range( buffer, spec, values, options );
+  if ( std::string_view( buffer.data(), buffer.size() ) != expected ) {
+    fmt::print( "FAILED: format_range {}\n", name );
+    ++failures;
+  }
+  if ( streamed( spec, values, options ) != expected ) {
+    fmt::print( "FAILED: write_range {}\n", name );
+    ++failures;
+  }
+}
+}
+
+[[maybe_unused]]
+int sc_main( [[maybe_unused]]int argc, [[maybe_unused]]char* argv[] )
+{
+  check_native<sc_dt::sc_int<1>>(   "sc_int<1>" );
+  check_native<sc_dt::sc_int<7>>(   "sc_int<7>" );
+  check_native<sc_dt::sc_int<8>>(   "sc_int<8>" );
+  check_native<sc_dt::sc_int<13>>(  "sc_int<13>" );
+  check_native<sc_dt::sc_int<32>>(  "sc_int<32>" );
+  check_native<sc_dt::sc_int<63>>(  "sc_int<63>" );
+  check_native<sc_dt::sc_int<64>>(  "sc_int<64>" );
+  check_native<sc_dt::sc_uint<1>>(  "sc_uint<1>" );
+  check_native<sc_dt::sc_uint<7>>(  "sc_uint<7>" );
+  check_native<sc_dt::sc_uint<8>>(  "sc_uint<8>" );
+  check_native<sc_dt::sc_uint<13>>( "sc_uint<13>" );
+  check_native<sc_dt::sc_uint<32>>( "sc_uint<32>" );
+  check_native<sc_dt::sc_uint<63>>( "sc_uint<63>" );
+  check_native<sc_dt::sc_uint<64>>( "sc_uint<64>" );
+
+  std::vector<std::uint32_t> words( 100'003 );
+  std::vector<sc_dt::sc_int<64>> ints( 20'011 );
+  std::vector<sc_dt::sc_uint<32>> uints( 20'011 );
+  std::vector<sc_dt::sc_lv<64>> lvs( 5'003 );
+  std::vector<sc_dt::sc_biguint<128>> bigs( 5'003 );
+  std::uint32_t x = 2463534242u;
+  for ( std::size_t i = 0; i < words.size(); ++i ) {
+    x ^= x << 13; x ^= x >> 17; x ^= x << 5; // xorshift
+    words[i] = x;
+    if ( i < ints.size() ) { ints[i] = static_cast<std::int64_t>( std::uint64_t( x ) << 32 | words[i / 2] ); }
+    if ( i < uints.size() ) { uints[i] = x; }
+    if ( i < lvs.size() ) { lvs[i] = x; }
+    if ( i < bigs.size() ) { bigs[i] = x; }
+  }
+
+  // Parallel: 4 threads, small chunks and blocks so write_range takes many rounds
+  check( "uint32 parallel", words, "{:x}\n", { 4, 100, 1000 } );
+  check( "uint32 default", words, "{:x}\n", {} );
+  check( "uint32 empty", std::vector<std::uint32_t>{}, "{:x}\n", { 4, 1, 1 } );
+  check( "sc_int<64> d", ints, "{}\n", { 4, 100, 1000 } );
+  check( "sc_int<64> mpx", ints, "{:mpx}\n", { 4, 100, 1000 } );
+  check( "sc_int<64> c", ints, "{:c}\n", { 4, 100, 1000 } ); // Locked to_string()
+  check( "sc_uint<32> x", uints, "{:x}\n", { 4, 100, 1000 } );
+  check( "sc_uint<32> upb", uints, "{:upb}\n", { 4, 100, 1000 } );
+  check( "sc_lv<64> l", lvs, "{}\n", { 4, 100, 1000 } );
+  check( "sc_lv<64> x", lvs, "{:x}\n", { 4, 100, 1000 } ); // Locked to_string()
+  // Serial: threads requested but sc_biguint is formatted on one thread
+  check( "sc_biguint<128>", bigs, "{:x}\n", { 4, 100, 1000 } );
+
+  if ( failures ) { return EXIT_FAILURE; }
+  fmt::print( "PASSED\n" );
+  return EXIT_SUCCESS;
+}
+
+// TAGS: Doulos, Systemc, format, bulk, test, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
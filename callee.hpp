@@ -0,0 +1,46 @@
+#pragma once
+
+// The blocking interface and its target from portexport.cpp, shared so that
+// other initiators (e.g. nb_bench.cpp) can compare against the same Callee.
+// See the diagram at the top of portexport.cpp.
+
+#include <systemc>
+#include "fixed_string.hpp"
+#include "report.hpp"
+
+using Data = FixedString<>; // Short messages travel inline (see payload_bench.cpp)
+
+struct IF : virtual sc_core::sc_interface
+{
+  virtual void xfer( Data& data ) = 0;
+};
+
+// Hierarchical channel
+struct Callee : sc_core::sc_module, private IF {
+  static constexpr const char* msg_type = "/Doulos/Example/Ports-n-Exports/Callee";
+  sc_core::sc_export<IF> SC_NAMED(x0);
+  explicit Callee( sc_core::sc_module_name const& instance ) // Constructor
+  : sc_core::sc_module{instance}, IF{}
+  {
+    x0.bind(*this);
+  }
+  void xfer( Data& data ) override
+  {
+    REPORT_INFO( "received {}",data );
+    // Save/load data
+    auto temp = data;
+    data = m_data;
+    // Transform data
+    if( temp == "Hello" ) temp = "Goodbye";
+    m_data = temp;
+  }
+private:
+  Data m_data{ "What's up?" };
+};
+
+// TAGS: Doulos, Systemc, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
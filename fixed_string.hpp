@@ -0,0 +1,163 @@
+#pragma once
+
+// Fixed-capacity, trivially copyable string payload for short messages.
+//
+// FixedString<Capacity> stores up to Capacity characters inline (plus a
+// terminating NUL), together with its length and a precomputed FNV-1a hash.
+// Unused bytes are always zero, so copies are plain memcpy's of the object and
+// equality compares length, hash and then the whole (fixed-size) buffer, which
+// compilers turn into a handful of vector loads.
+//
+// Usage:
+//   using Data = FixedString<>;   // 31 characters + NUL
+//   Data d{ "Hello" };
+//   if( d == "Hello" ) d = "Goodbye";
+//   fmt::print( "{}\n", d );
+//
+// Character arrays (literals or buffers) are read up to their first NUL, or in
+// full when they hold none. Arrays that could never fit are rejected at compile
+// time; an array one longer than Capacity fits only if it holds a NUL, and
+// throws std::length_error otherwise, as do runtime strings that do not fit.
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <fmt/format.h>
+
+template< std::size_t Capacity = 31 >
+class FixedString {
+  static_assert( Capacity > 0, "FixedString needs room for at least one character" );
+public:
+  static constexpr std::size_t capacity = Capacity;
+
+  constexpr FixedString() noexcept = default;
+
+  template< std::size_t N > // String literals and char buffers (up to the first NUL)
+  constexpr FixedString( const char (&text)[N] ) noexcept( N <= Capacity ) // NOLINT: implicit on purpose
+  {
+    static_assert( N - 1 <= Capacity, "Character array exceeds FixedString capacity" );
+    auto size = length_of( text );
+    if constexpr ( N > Capacity ) { // Only an unterminated array can overflow
+      if ( size > Capacity ) {
+        throw std::length_error( "FixedString capacity exceeded" );
+      }
+    }
+    assign_unchecked( text, size );
+  }
+
+  explicit FixedString( std::string_view text )
+  {
+    if ( text.size() > Capacity ) {
+      throw std::length_error( "FixedString capacity exceeded" );
+    }
+    assign_unchecked( text.data(), text.size() );
+  }
+
+  explicit FixedString( const std::string& text ) : FixedString{ std::string_view{ text } } {}
+
+  constexpr auto size()   const noexcept -> std::size_t      { return m_size; }
+  constexpr auto empty()  const noexcept -> bool             { return m_size == 0; }
+  constexpr auto hash()   const noexcept -> std::uint64_t    { return m_hash; }
+  constexpr auto data()   const noexcept -> const char*      { return m_text; }
+  constexpr auto c_str()  const noexcept -> const char*      { return m_text; }
+  constexpr auto view()   const noexcept -> std::string_view { return { m_text, m_size }; }
+  constexpr operator std::string_view() const noexcept { return view(); }
+  auto str() const -> std::string { return std::string{ view() }; }
+
+  friend auto operator==( const FixedString& lhs, const FixedString& rhs ) noexcept -> bool
+  {
+    // Padding is zero-filled, so comparing the full buffer is exact
+    return lhs.m_size == rhs.m_size
+        && lhs.m_hash == rhs.m_hash
+        && std::memcmp( lhs.m_text, rhs.m_text, sizeof( m_text ) ) == 0;
+  }
+  friend auto operator!=( const FixedString& lhs, const FixedString& rhs ) noexcept -> bool
+  {
+    return !( lhs == rhs );
+  }
+
+  template< std::size_t N > // Length of a literal folds to a constant
+  friend auto operator==( const FixedString& lhs, const char (&rhs)[N] ) noexcept -> bool
+  {
+    auto size = length_of( rhs );
+    return lhs.m_size == size && std::memcmp( lhs.m_text, rhs, size ) == 0;
+  }
+  template< std::size_t N >
+  friend auto operator!=( const FixedString& lhs, const char (&rhs)[N] ) noexcept -> bool
+  {
+    return !( lhs == rhs );
+  }
+
+  friend auto operator==( const FixedString& lhs, std::string_view rhs ) noexcept -> bool
+  {
+    return lhs.view() == rhs;
+  }
+  friend auto operator!=( const FixedString& lhs, std::string_view rhs ) noexcept -> bool
+  {
+    return !( lhs == rhs );
+  }
+
+  // Characters before the first NUL, or N if there is none
+  template< std::size_t N >
+  static constexpr auto length_of( const char (&text)[N] ) noexcept -> std::size_t
+  {
+    std::size_t size = 0;
+    while ( size < N && text[size] != '\0' ) { ++size; }
+    return size;
+  }
+
+  // 64-bit FNV-1a
+  static constexpr auto hash_of( const char* text, std::size_t size ) noexcept -> std::uint64_t
+  {
+    std::uint64_t h = 0xcbf29ce484222325ULL;
+    for ( std::size_t i = 0; i < size; ++i ) {
+      h ^= static_cast<unsigned char>( text[i] );
+      h *= 0x100000001b3ULL;
+    }
+    return h;
+  }
+
+private:
+  constexpr void assign_unchecked( const char* text, std::size_t size ) noexcept
+  {
+    for ( std::size_t i = 0; i < size; ++i ) { m_text[i] = text[i]; }
+    m_size = static_cast<std::uint32_t>( size );
+    m_hash = hash_of( text, size );
+  }
+
+  std::uint64_t m_hash{ hash_of( "", 0 ) };
+  std::uint32_t m_size{ 0 };
+  char          m_text[Capacity + 1]{};
+};
+
+static_assert( std::is_trivially_copyable_v<FixedString<>> );
+
+//------------------------------------------------------------------------------
+template< std::size_t Capacity >
+struct std::hash<FixedString<Capacity>> {
+  auto operator()( const FixedString<Capacity>& text ) const noexcept -> std::size_t
+  {
+    return static_cast<std::size_t>( text.hash() );
+  }
+};
+
+//------------------------------------------------------------------------------
+template< std::size_t Capacity > // Custom formatter for FixedString<Capacity>
+struct fmt::formatter<FixedString<Capacity>> : fmt::formatter<std::string_view> {
+  auto format( const FixedString<Capacity>& text, format_context& ctx ) const -> decltype( ctx.out() )
+  {
+    return fmt::formatter<std::string_view>::format( text.view(), ctx );
+  }
+};
+
+// TAGS: Doulos, Systemc, payload, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
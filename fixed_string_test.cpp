@@ -0,0 +1,96 @@
+// Checks FixedString construction, comparison, hashing and formatting.
+
+#include <systemc>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include "fixed_string.hpp"
+
+namespace {
+int failures = 0;
+void check( bool ok, const char* what )
+{
+  if ( !ok ) {
+    fmt::print( "FAILED: {}\n", what );
+    ++failures;
+  }
+}
+}
+
+[[maybe_unused]]
+int sc_main( [[maybe_unused]]int argc, [[maybe_unused]]char* argv[] )
+{
+  using Data = FixedString<>;
+
+  // Literal
+  constexpr Data hello{ "Hello" };
+  check( hello.size() == 5, "literal size" );
+  check( hello == "Hello" && hello != "Hell" && hello != "Hello!", "literal comparison" );
+  check( std::string_view{ hello.c_str() } == "Hello", "NUL terminated" );
+  check( Data{}.empty() && Data{ "" } == Data{}, "empty" );
+
+  // Character buffer: only up to the first NUL counts
+  char buf[16] = "Hi";
+  Data from_buf{ buf };
+  check( from_buf.size() == 2, "buffer size stops at NUL" );
+  check( from_buf == "Hi" && from_buf == Data{ "Hi" }, "buffer equals literal" );
+  check( Data{ "Hi" } == buf, "literal equals buffer" );
+  char full[4] = { 'a', 'b', 'c', 'd' }; // No NUL: every character counts
+  check( Data{ full }.size() == 4 && Data{ full } == "abcd", "unterminated buffer kept whole" );
+  check( Data{ "abcd" } == full, "literal equals unterminated buffer" );
+
+  // string_view / std::string
+  Data from_view{ std::string_view{ "World" } };
+  check( from_view == "World" && from_view == std::string_view{ "World" }, "string_view" );
+  check( Data{ std::string( 31, 'x' ) }.size() == 31, "full capacity" );
+
+  // Overflow
+  bool threw = false;
+  try {
+    Data too_long{ std::string( 32, 'x' ) };
+  } catch ( std::length_error const& ) {
+    threw = true;
+  }
+  check( threw, "overflow throws length_error" );
+  char max_buf[32] = "0123456789012345678901234567890"; // 31 characters + NUL
+  check( Data{ max_buf }.size() == 31, "terminated buffer at capacity" );
+  max_buf[31] = '!'; // 32 characters, no NUL
+  threw = false;
+  try {
+    Data too_long{ max_buf };
+  } catch ( std::length_error const& ) {
+    threw = true;
+  }
+  check( threw, "unterminated overflow throws length_error" );
+
+  // Hash
+  check( hello.hash() == Data{ std::string_view{ "Hello" } }.hash(), "hash independent of source" );
+  check( hello.hash() != from_view.hash(), "hash differs" );
+  check( Data{}.hash() == Data::hash_of( "", 0 ), "empty hash" );
+  std::unordered_set<Data> set{ "Hello", "World" };
+  check( set.count( from_view ) == 1 && set.count( Data{ "Goodbye" } ) == 0, "std::hash" );
+
+  // Copy/assign
+  Data copy = hello;
+  check( copy == hello, "copy" );
+  copy = "Goodbye";
+  check( copy == "Goodbye" && copy.size() == 7, "assign" );
+
+  // Formatter
+  check( fmt::format( "{}", hello ) == "Hello", "format" );
+  check( fmt::format( "[{:>7}]", hello ) == "[  Hello]", "format spec" );
+  check( fmt::format( "{}", from_buf ) == "Hi", "format buffer" );
+
+  if ( failures ) { return EXIT_FAILURE; }
+  fmt::print( "PASSED\n" );
+  return EXIT_SUCCESS;
+}
+
+// TAGS: Doulos, Systemc, payload, test, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
@@ -0,0 +1,137 @@
+// Throughput of NB_IF::nb_xfer versus the number of outstanding transactions.
+//
+// Several initiator/target pairs run one after another. Each target is a
+// PipelinedCallee with the same depth and latency; each initiator keeps a
+// different number of transactions in flight. Throughput is reported in
+// transactions per simulated microsecond (set by depth and latency, a sanity
+// check) and in transactions per wall-clock second (the simulator cost, the
+// figure to watch). Each initiator waits for the previous one to finish, so
+// its wall-clock time is not shared with the others.
+//
+// Every initiator's responses are checked against the blocking Callee (see
+// callee.hpp) fed the same input sequence, so the pipeline must reproduce
+// the blocking behaviour and not merely agree with itself across depths.
+//
+// Usage: nb_bench [transactions [pipeline-depth [latency-ns]]]
+
+#include <systemc>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+#include "sc_format.hpp"
+#include "fixed_string.hpp"
+#include "callee.hpp"
+#include "nb_xfer.hpp"
+
+using namespace sc_core;
+
+namespace {
+// Request i of every initiator
+auto request( std::size_t i ) -> Data { return ( i & 1 ) ? Data{ "World" } : Data{ "Hello" }; }
+// Order-sensitive digest of a response sequence
+auto digest( std::uint64_t sum, Data const& response ) -> std::uint64_t
+{
+  return ( sum ^ response.hash() ) * 0x100000001b3ULL;
+}
+}
+
+struct NbCaller : sc_module {
+  sc_port<NB_IF<Data>> SC_NAMED(p0);
+  NbCaller( sc_module_name const& instance, std::size_t count, std::size_t outstanding, NbCaller const* previous )
+  : sc_module{instance}, m_count{count}, m_outstanding{outstanding}, m_previous{previous}
+  {
+    SC_THREAD( thread1 );
+  }
+  void thread1()
+  {
+    if( m_previous ) wait( m_previous->m_done_event );
+    m_started = sc_time_stamp();
+    auto start = std::chrono::steady_clock::now();
+    std::vector<NbTransaction<Data>> ring( m_outstanding );
+    for( std::size_t i = 0; i < m_count + m_outstanding; ++i ) {
+      auto& trans = ring[ i % m_outstanding ];
+      // Oldest transaction in the ring retires first
+      if( !trans.done ) wait( trans.done_event );
+      if( i >= m_outstanding ) m_digest = digest( m_digest, trans.data ); // Response to request i - m_outstanding
+      if( i >= m_count ) continue; // draining
+      trans.data = request( i );
+      while( p0->nb_xfer( trans ) == NbStatus::busy ) wait( p0->ready_event() );
+    }
+    m_finished = sc_time_stamp();
+    m_elapsed  = std::chrono::steady_clock::now() - start;
+    m_done_event.notify( SC_ZERO_TIME );
+  }
+  std::size_t     m_count;
+  std::size_t     m_outstanding;
+  NbCaller const* m_previous;
+  std::uint64_t   m_digest{};
+  sc_time         m_started{};
+  sc_time         m_finished{};
+  std::chrono::duration<double> m_elapsed{};
+  sc_event        m_done_event{ "done_event" };
+};
+
+struct NbTop : sc_module {
+  NbCaller              caller;
+  PipelinedCallee<Data> callee;
+  NbTop( sc_module_name const& instance, std::size_t count, std::size_t outstanding, std::size_t depth, sc_time const& latency, NbTop const* previous )
+  : sc_module{instance}, caller{ "caller", count, outstanding, previous ? &previous->caller : nullptr }, callee{ "callee", depth, latency }
+  {
+    caller.p0.bind( callee.nb_x0 );
+  }
+};
+
+[[maybe_unused]]
+int sc_main( int argc, char* argv[] )
+{
+  std::size_t count = ( argc > 1 ) ? std::strtoull( argv[1], nullptr, 0 ) : 1'000'000;
+  std::size_t depth = ( argc > 2 ) ? std::strtoull( argv[2], nullptr, 0 ) : 16;
+  double      ns    = ( argc > 3 ) ? std::strtod( argv[3], nullptr ) : 10.0;
+  sc_time latency{ ns, SC_NS };
+
+  std::vector<std::unique_ptr<NbTop>> tops;
+  for( std::size_t outstanding = 1; outstanding <= 2 * depth; outstanding *= 2 ) {
+    auto name = fmt::format( "top_{}", outstanding );
+    auto previous = tops.empty() ? nullptr : tops.back().get();
+    tops.emplace_back( std::make_unique<NbTop>( name.c_str(), count, outstanding, depth, latency, previous ) );
+  }
+  // Reference for the responses: the blocking Callee (its per-call info report muted)
+  Callee reference{ "reference" };
+  sc_report_handler::set_actions( fmt::format( "{}/xfer", Callee::msg_type ).c_str(), SC_INFO, SC_DO_NOTHING );
+
+  sc_start();
+
+  std::uint64_t expected{};
+  for( std::size_t i = 0; i < count; ++i ) {
+    auto data = request( i );
+    reference.x0->xfer( data );
+    expected = digest( expected, data );
+  }
+
+  fmt::print( "{} transactions, pipeline depth {}, latency {}\n", count, depth, latency );
+  fmt::print( "{:>11} {:>14} {:>16} {:>10} {:>14}\n", "outstanding", "sim time", "trans/sim-us", "wall s", "trans/s" );
+  int status = 0;
+  for( auto const& top : tops ) {
+    auto const& caller = top->caller;
+    auto sim     = caller.m_finished - caller.m_started;
+    auto seconds = caller.m_elapsed.count();
+    fmt::print( "{:>11} {:>14} {:>16.2f} {:>10.3f} {:>14.0f}\n",
+                caller.m_outstanding, sim.to_string(),
+                caller.m_count / sim.to_seconds() * 1e-6,
+                seconds, caller.m_count / seconds );
+    if( caller.m_digest != expected ) {
+      fmt::print( "FAILED: responses with {} outstanding differ from the blocking Callee\n", caller.m_outstanding );
+      status = 1;
+    }
+  }
+  return status;
+}
+
+// TAGS: Doulos, Systemc, non-blocking, benchmark, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
@@ -0,0 +1,112 @@
+#pragma once
+
+// Non-blocking counterpart of IF::xfer (see callee.hpp).
+//
+// NB_IF<T>::nb_xfer() starts a transfer and returns immediately:
+//   + NbStatus::accepted -> the transaction is in flight; trans.done becomes
+//     true and trans.done_event is notified when trans.data holds the response
+//   + NbStatus::busy     -> the target pipeline is full; wait for
+//     ready_event() and retry
+// The initiator owns the transaction and must keep it alive until done.
+// Passing a transaction that is still in flight is an error (REPORT_ERROR);
+// if that error is configured not to throw, nb_xfer() returns busy.
+//
+// PipelinedCallee<T> implements NB_IF<T> with the same save/load/transform
+// behaviour as Callee, a configurable number of outstanding transactions
+// (depth) and a fixed latency per transaction. Responses retire in order.
+//
+//   PipelinedCallee<Data> callee{ "callee", 8, sc_time{ 10, SC_NS } };
+//   NbTransaction<Data> trans; trans.data = "Hello";
+//   while( p->nb_xfer( trans ) == NbStatus::busy ) wait( p->ready_event() );
+//   ...do other work...
+//   if( !trans.done ) wait( trans.done_event );
+
+#include <systemc>
+#include <cstddef>
+#include <deque>
+#include "report.hpp"
+
+enum class NbStatus { accepted, busy };
+
+template< typename T >
+struct NbTransaction {
+  T                 data{};
+  bool              done{ true }; // false while in flight
+  sc_core::sc_event done_event{};
+};
+
+template< typename T >
+struct NB_IF : virtual sc_core::sc_interface
+{
+  virtual NbStatus nb_xfer( NbTransaction<T>& trans ) = 0;
+  virtual const sc_core::sc_event& ready_event() const = 0; // a pipeline slot was freed
+};
+
+// Hierarchical channel
+template< typename T >
+struct PipelinedCallee : sc_core::sc_module, private NB_IF<T> {
+  static constexpr const char* msg_type = "/Doulos/Example/Ports-n-Exports/PipelinedCallee";
+  sc_core::sc_export<NB_IF<T>> SC_NAMED(nb_x0);
+  PipelinedCallee( sc_core::sc_module_name const& instance, std::size_t depth, sc_core::sc_time const& latency ) // Constructor
+  : sc_core::sc_module{instance}, NB_IF<T>{}, m_depth{ depth }, m_latency{ latency }
+  {
+    if( m_depth == 0 ) {
+      REPORT_FATAL( "pipeline depth must be at least 1" );
+    }
+    nb_x0.bind(*this);
+    SC_METHOD( retire_method );
+    sensitive << m_retire_event;
+    dont_initialize();
+  }
+  NbStatus nb_xfer( NbTransaction<T>& trans ) override
+  {
+    if( !trans.done ) {
+      REPORT_ERROR( "transaction is already in flight" );
+      return NbStatus::busy;
+    }
+    if( m_pipeline.size() >= m_depth ) return NbStatus::busy;
+    trans.done = false;
+    m_pipeline.push_back( { &trans, sc_core::sc_time_stamp() + m_latency } );
+    if( m_pipeline.size() == 1 ) m_retire_event.notify( m_latency );
+    return NbStatus::accepted;
+  }
+  const sc_core::sc_event& ready_event() const override { return m_ready_event; }
+  std::size_t depth() const { return m_depth; }
+  sc_core::sc_time const& latency() const { return m_latency; }
+private:
+  void retire_method()
+  {
+    auto now = sc_core::sc_time_stamp();
+    while( !m_pipeline.empty() && m_pipeline.front().ready <= now ) {
+      auto& trans = *m_pipeline.front().trans;
+      m_pipeline.pop_front();
+      // Save/load data
+      auto temp = trans.data;
+      trans.data = m_data;
+      // Transform data
+      if( temp == "Hello" ) temp = "Goodbye";
+      m_data = temp;
+      trans.done = true;
+      trans.done_event.notify( sc_core::SC_ZERO_TIME );
+    }
+    m_ready_event.notify( sc_core::SC_ZERO_TIME );
+    if( !m_pipeline.empty() ) m_retire_event.notify( m_pipeline.front().ready - now );
+  }
+  struct Stage {
+    NbTransaction<T>* trans;
+    sc_core::sc_time   ready;
+  };
+  std::size_t       m_depth;
+  sc_core::sc_time  m_latency;
+  std::deque<Stage> m_pipeline;
+  sc_core::sc_event m_retire_event;
+  sc_core::sc_event m_ready_event;
+  T                 m_data{ "What's up?" };
+};
+
+// TAGS: Doulos, Systemc, non-blocking, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
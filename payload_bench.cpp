@@ -0,0 +1,106 @@
+// Compares transaction throughput of the port/export xfer path when the
+// payload is a std::string versus an inline FixedString<>.
+//
+// Each transaction follows the same pattern as Caller::thread1() and
+// Callee::xfer() in portexport.cpp: a blocking call through sc_port/sc_export,
+// a save/load swap of the payload, and a comparison against a literal.
+//
+// Usage: payload_bench [transactions]
+
+#include <systemc>
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "fixed_string.hpp"
+
+using namespace sc_core;
+
+template< typename T >
+struct Xfer_if : virtual sc_interface
+{
+  virtual void xfer( T& data ) = 0;
+};
+
+template< typename T >
+struct Bench_caller : sc_module {
+  sc_port<Xfer_if<T>> SC_NAMED(p0);
+  Bench_caller( sc_module_name const& instance, std::size_t count )
+  : sc_module{instance}, m_count{count}
+  {
+    SC_THREAD( thread1 );
+  }
+  void thread1()
+  {
+    std::vector<T> datavec = { "Hello", "World" };
+    auto start = std::chrono::steady_clock::now();
+    for( std::size_t i = 0; i < m_count; ++i ) {
+      auto v = datavec[ i & 1 ];
+      p0->xfer( v );
+      if( v == "Goodbye" ) ++m_goodbyes;
+    }
+    m_elapsed = std::chrono::steady_clock::now() - start;
+  }
+  std::size_t m_count;
+  std::size_t m_goodbyes{};
+  std::chrono::duration<double> m_elapsed{};
+};
+
+template< typename T >
+struct Bench_callee : sc_module, private Xfer_if<T> {
+  sc_export<Xfer_if<T>> SC_NAMED(x0);
+  explicit Bench_callee( sc_module_name const& instance )
+  : sc_module{instance}
+  {
+    x0.bind(*this);
+  }
+  void xfer( T& data ) override
+  {
+    auto temp = data;
+    data = m_data;
+    if( temp == "Hello" ) temp = "Goodbye";
+    m_data = temp;
+  }
+  T m_data{ "What's up?" };
+};
+
+template< typename T >
+struct Bench_top : sc_module {
+  Bench_caller<T> caller;
+  Bench_callee<T> callee;
+  Bench_top( sc_module_name const& instance, std::size_t count )
+  : sc_module{instance}, caller{ "caller", count }, callee{ "callee" }
+  {
+    caller.p0.bind( callee.x0 );
+  }
+};
+
+[[maybe_unused]]
+int sc_main( int argc, char* argv[] )
+{
+  std::size_t count = ( argc > 1 ) ? std::strtoull( argv[1], nullptr, 0 ) : 10'000'000;
+
+  // Both tops elaborate together and run concurrently in one sc_start(); the
+  // threads never yield, so each measurement sees the kernel to itself.
+  Bench_top<std::string>   string_top{ "string_top", count };
+  Bench_top<FixedString<>> fixed_top{ "fixed_top", count };
+  sc_start();
+
+  auto report = []( const char* name, auto const& top ) {
+    auto seconds = top.caller.m_elapsed.count();
+    fmt::print( "{:<16} {:>12} transactions in {:8.3f} s = {:>14.0f} transactions/s (goodbyes={})\n",
+                name, top.caller.m_count, seconds, top.caller.m_count / seconds, top.caller.m_goodbyes );
+    return seconds;
+  };
+  auto string_seconds = report( "std::string", string_top );
+  auto fixed_seconds  = report( "FixedString<31>", fixed_top );
+  fmt::print( "Speedup: {:.2f}x\n", string_seconds / fixed_seconds );
+  return ( string_top.caller.m_goodbyes == fixed_top.caller.m_goodbyes ) ? 0 : 1;
+}
+
+// TAGS: Doulos, Systemc, payload, benchmark, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
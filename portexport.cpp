@@ -45,14 +45,11 @@
 #include <string>
 #include <string_view>
 #include "sc_format.hpp"
+#include "fixed_string.hpp"
+#include "report.hpp"
+#include "callee.hpp" // Data, IF and Callee
 
 using namespace sc_core;
-using Data = std::string;
-
-struct IF : virtual sc_interface
-{
-  virtual void xfer( Data& data ) = 0;
-};
 
 SC_MODULE( Caller ) {
   static constexpr const char* msg_type = "/Doulos/Example/Ports-n-Exports/Caller";
@@ -63,40 +60,17 @@ SC_MODULE( Caller ) {
   }
   void thread1()
   {
-    SC_REPORT_INFO( fmt::format("{}/{}",msg_type,__func__).c_str(), fmt::format("Initiating process").c_str() );
+    REPORT_INFO( "Initiating process" );
     std::vector<Data> datavec = { "Hello", "World" };
     for( auto& v : datavec ) {
-      SC_REPORT_INFO( fmt::format("{}/{}",msg_type,__func__).c_str(), fmt::format("sending {}",v).c_str() );
+      REPORT_INFO( "sending {}",v );
       p0->xfer( v );
-      SC_REPORT_INFO( fmt::format("{}/{}",msg_type,__func__).c_str(), fmt::format("received {}",v).c_str() );
+      REPORT_INFO( "received {}",v );
     }
     sc_core::sc_stop();
   }
 };
 
-// Hierarchical channel
-struct Callee : sc_module, private IF {
-  static constexpr const char* msg_type = "/Doulos/Example/Ports-n-Exports/Callee";
-  sc_export<IF> SC_NAMED(x0);
-  explicit Callee( sc_module_name const& instance ) // Constructor
-  : sc_module{instance}, IF{}
-  {
-    x0.bind(*this);
-  }
-  void xfer( Data& data ) override
-  {
-    SC_REPORT_INFO( fmt::format("{}/{}",msg_type,__func__).c_str(), fmt::format("received {}",data).c_str() );
-    // Save/load data
-    auto temp = data;
-    data = m_data;
-    // Transform data
-    if( temp == "Hello" ) temp = "Goodbye";
-    m_data = temp;
-  }
-private:
-  Data m_data{ "What's up?" };
-};
-
 SC_MODULE( Initiator ) {
   sc_port<IF> SC_NAMED(p1);
   Caller      SC_NAMED(caller);
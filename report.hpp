@@ -0,0 +1,80 @@
+#pragma once
+
+// Allocation-free message formatting for SystemC reports.
+//
+// Each thread owns two reusable fmt::memory_buffer's (report type and message).
+// Messages are formatted into them (NUL terminated) and handed to SC_REPORT_*
+// as const char*, so once a buffer has grown to the longest message seen (most
+// never leave the 500 byte inline storage) formatting the message allocates
+// nothing.
+//
+// Usage inside a module that defines msg_type:
+//   REPORT_INFO( "sending {}", v );
+// is equivalent to
+//   SC_REPORT_INFO( fmt::format("{}/{}",msg_type,__func__).c_str(), fmt::format("sending {}",v).c_str() );
+//
+// The returned pointers stay valid until the same slot is formatted again on
+// the same thread, which is long enough for SC_REPORT_* (it copies them).
+// Stamping a message with sc_time_stamp() is cheap: the sc_time formatter
+// renders the current time once per time step (see sc_time_cache.hpp).
+// This does NOT make a whole report allocation-free:
+// + SC_REPORT_* itself still allocates inside SystemC (sc_report copies the
+//   type and message) on every call
+// + the sc_format.hpp formatters built on SystemC's to_string() still
+//   allocate (sc_logic and the current sc_time do not)
+// The buffers only remove the std::string temporaries of the message text.
+
+#include <systemc>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <fmt/format.h>
+
+namespace report {
+
+enum Slot : std::size_t { type_slot, message_slot, slot_count };
+
+// Per-thread reusable buffer
+inline auto buffer( Slot slot ) -> fmt::memory_buffer&
+{
+  thread_local fmt::memory_buffer buffers[slot_count];
+  return buffers[slot];
+}
+
+// Format into a reused buffer and return it as a NUL terminated string
+template< typename... Args >
+auto format( Slot slot, fmt::format_string<Args...> fmtstr, Args&&... args ) -> const char*
+{
+  auto& buf = buffer( slot );
+  buf.clear();
+  fmt::format_to( std::back_inserter( buf ), fmtstr, std::forward<Args>( args )... );
+  buf.push_back( '\0' );
+  return buf.data();
+}
+
+// "<msg_type>/<func>"
+inline auto type( const char* msg_type, const char* func ) -> const char*
+{
+  return format( type_slot, "{}/{}", msg_type, func );
+}
+
+template< typename... Args >
+auto message( fmt::format_string<Args...> fmtstr, Args&&... args ) -> const char*
+{
+  return format( message_slot, fmtstr, std::forward<Args>( args )... );
+}
+
+}//end namespace report
+
+// Macros keep __FILE__/__LINE__ of the caller in the report
+#define REPORT_INFO( ... )    SC_REPORT_INFO(    report::type( msg_type, __func__ ), report::message( __VA_ARGS__ ) )
+#define REPORT_WARNING( ... ) SC_REPORT_WARNING( report::type( msg_type, __func__ ), report::message( __VA_ARGS__ ) )
+#define REPORT_ERROR( ... )   SC_REPORT_ERROR(   report::type( msg_type, __func__ ), report::message( __VA_ARGS__ ) )
+#define REPORT_FATAL( ... )   SC_REPORT_FATAL(   report::type( msg_type, __func__ ), report::message( __VA_ARGS__ ) )
+
+// TAGS: Doulos, Systemc, format, report, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
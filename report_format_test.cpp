@@ -0,0 +1,80 @@
+// Verifies that report.hpp formats steady-state report messages (type and
+// text) without any heap allocation. Global operator new is replaced with a
+// counting version; after a warm-up pass every further message must allocate
+// nothing.
+//
+// The message includes the sc_format.hpp formatters that avoid to_string():
+// sc_logic (to_char()) and the current sc_time (TimeCache). SC_REPORT_* itself
+// and the formatters built on to_string() still allocate, so neither is
+// exercised.
+
+#include <systemc>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "report.hpp"
+#include "fixed_string.hpp"
+#include "sc_format.hpp"
+
+namespace {
+std::atomic<std::size_t> allocations{ 0 };
+}
+
+auto operator new( std::size_t size ) -> void*
+{
+  ++allocations;
+  if ( void* p = std::malloc( size ? size : 1 ) ) { return p; }
+  throw std::bad_alloc{};
+}
+auto operator new[]( std::size_t size ) -> void* { return operator new( size ); }
+void operator delete( void* p ) noexcept { std::free( p ); }
+void operator delete[]( void* p ) noexcept { std::free( p ); }
+void operator delete( void* p, std::size_t ) noexcept { std::free( p ); }
+void operator delete[]( void* p, std::size_t ) noexcept { std::free( p ); }
+
+struct Reporter {
+  static constexpr const char* msg_type = "/Doulos/Example/Ports-n-Exports/Reporter";
+  // Builds the same strings REPORT_INFO would hand to SC_REPORT_INFO
+  auto build( int i, FixedString<> const& data, std::string const& text, sc_dt::sc_logic const& valid ) -> std::size_t
+  {
+    auto type    = report::type( msg_type, __func__ );
+    auto message = report::message( "{} transaction {} sending {} ({}) {:08x} valid={}",
+                                    sc_core::sc_time_stamp(), i, data, text, i * 7919, valid );
+    return std::char_traits<char>::length( type ) + std::char_traits<char>::length( message );
+  }
+};
+
+[[maybe_unused]]
+int sc_main( [[maybe_unused]]int argc, [[maybe_unused]]char* argv[] )
+{
+  constexpr int warmup = 16;
+  constexpr int reports = 100'000;
+  Reporter reporter;
+  FixedString<> data{ "Hello" };
+  std::string text( 200, 'x' ); // Longer than the small-string buffer; built before counting
+  sc_dt::sc_logic valid{ sc_dt::Log_1 };
+  std::size_t total = 0;
+
+  for ( int i = 0; i < warmup; ++i ) { total += reporter.build( i, data, text, valid ); }
+
+  auto before = allocations.load();
+  for ( int i = 0; i < reports; ++i ) { total += reporter.build( i, data, text, valid ); }
+  auto after = allocations.load();
+
+  auto per_report = double( after - before ) / reports;
+  fmt::print( "{} messages ({} bytes): {} allocations ({} per message)\n", reports, total, after - before, per_report );
+  if ( after != before ) {
+    fmt::print( "FAILED: report message formatting allocated after warm-up\n" );
+    return EXIT_FAILURE;
+  }
+  fmt::print( "PASSED\n" );
+  return EXIT_SUCCESS;
+}
+
+// TAGS: Doulos, Systemc, format, report, test, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
@@ -0,0 +1,17 @@
+// Compiled part of sc_format.hpp (see "Build modes" there): the non-template
+// formatters and explicit instantiations of the common widths, so translation
+// units that log do not each re-instantiate them.
+
+#define SC_FORMAT_IMPLEMENTATION
+#include "sc_format.hpp"
+
+#define SC_FORMAT_INSTANTIATE( T, W ) template struct fmt::formatter<sc_dt::T<W>>;
+SC_FORMAT_ALL_WIDTHS( SC_FORMAT_INSTANTIATE )
+#undef SC_FORMAT_INSTANTIATE
+
+// TAGS: Doulos, Systemc, format, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
@@ -1,7 +1,7 @@
 #pragma once
 
 // Formatters for:
-// + sc_time       {:[t]}
+// + sc_time       {:[t|r]}
 // + sc_int<W>     {:[u|m][p][c|d|b|o|x]}
 // + sc_uint<W>    {:[u|m][p][c|d|b|o|x]}
 // + sc_bigint<W>  {:[u|m][p][c|d|b|o|x]}
@@ -15,6 +15,7 @@
 //
 // where:
 //   t -> time
+//   r -> raw ticks (multiples of the time resolution)
 //   u -> unsigned two's complement
 //   m -> signed-magniture
 //   p -> prefix
@@ -25,10 +26,42 @@
 //   f -> full
 //   o -> octal
 //   x -> hexadecimal
+//
+// Build modes:
+//   default               -> non-template formatters are compiled once in
+//                            sc_format.cpp and common widths are explicitly
+//                            instantiated there (see SC_FORMAT_*_WIDTHS); link
+//                            the sc_format library
+//   SC_FORMAT_HEADER_ONLY -> everything is compiled inline in each translation
+//                            unit; no library needed
+// Headers that only need to name these types/formatters can include the
+// lighter sc_format_fwd.hpp instead.
+//
+// Thread safety: most formatters call SystemC's to_string(), which goes
+// through shared, unlocked state (sc_fix/sc_ufix temporaries and static
+// buffers), so they must not run on several threads at once. The exceptions,
+// which sc_format_bulk.hpp may run in parallel, are:
+// + sc_int<W>/sc_uint<W>: rendered natively from the 64-bit value, except
+//   'c', which calls to_string() under detail::to_string_mutex()
+// + sc_lv<W>: 'l' only reads the bits; the numeric forms call to_string()
+//   under detail::to_string_mutex()
+// + sc_logic
 
 #include <systemc>
+#include <algorithm>
+#include <mutex>
 #include <string>
 #include <fmt/format.h>
+#include "sc_format_fwd.hpp"
+
+#if defined( SC_FORMAT_HEADER_ONLY )
+#  define SC_FORMAT_INLINE inline
+#else
+#  define SC_FORMAT_INLINE
+#endif
+#if defined( SC_FORMAT_HEADER_ONLY ) || defined( SC_FORMAT_IMPLEMENTATION )
+#  include "sc_time_cache.hpp"
+#endif
 
 using namespace std::string_view_literals;
 
@@ -39,20 +72,105 @@ struct fmt::formatter<sc_core::sc_time> : fmt::formatter<std::string> {
   constexpr auto parse( format_parse_context& ctx ) -> decltype( ctx.begin() )
   {
     auto it = ctx.begin(), end = ctx.end();
-    if ( it != end && ( *it == 't' ) ) { presentation = *it++; }
+    if ( it != end && ( *it == 't' || *it == 'r' ) ) { presentation = *it++; }
     if ( it != end && *it != '}' ) { throw format_error( "invalid format" ); }
     return it;
   }
 
-  auto format( const sc_core::sc_time& time, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    if ( presentation == 't' ) {
-      return format_to( ctx.out(), "{}", time.to_string() );
-    } else {
-      return format_to( ctx.out(), "Formatting error to sc_time" );
+  auto format( const sc_core::sc_time& time, format_context& ctx ) const -> decltype( ctx.out() );
+};
+
+#if defined( SC_FORMAT_HEADER_ONLY ) || defined( SC_FORMAT_IMPLEMENTATION )
+SC_FORMAT_INLINE
+auto fmt::formatter<sc_core::sc_time>::format( const sc_core::sc_time& time, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  if ( presentation == 't' ) {
+    // The current time (by far the most common) comes pre-rendered from the cache
+    if ( time.value() == sc_core::sc_time_stamp().value() ) {
+      return format_to( ctx.out(), "{}", TimeCache::current().text() );
     }
+    return format_to( ctx.out(), "{}", time.to_string() );
+  } else if ( presentation == 'r' ) {
+    return format_to( ctx.out(), "{}", time.value() );
+  } else {
+    return format_to( ctx.out(), "Formatting error to sc_time" );
   }
-};
+}
+#endif
+
+//------------------------------------------------------------------------------
+namespace sc_format::detail {
+
+// Writes a W-bit sc_int (is_signed) or sc_uint value exactly as its
+// to_string( numrep, prefix ) does for presentation d/b/o/x and sign '-'/u/m,
+// using only the value (sign-extended to 64 bits for sc_int). SystemC prints
+// these through an sc_fix/sc_ufix of W integer bits, so e.g. sc_uint's plain
+// b/o/x gain a leading 0 bit and sc_int's 'u' forms drop the sign bit and
+// print "negative" for negative values.
+auto format_int( fmt::format_context::iterator out, sc_dt::uint64 value, bool is_signed, int width,
+                 char presentation, char sign, bool prefix ) -> fmt::format_context::iterator;
+
+// Held around the to_string() calls of formatters that may run in parallel
+auto to_string_mutex() -> std::mutex&;
+
+}//end namespace sc_format::detail
+
+#if defined( SC_FORMAT_HEADER_ONLY ) || defined( SC_FORMAT_IMPLEMENTATION )
+SC_FORMAT_INLINE
+auto sc_format::detail::format_int( fmt::format_context::iterator out, sc_dt::uint64 value, bool is_signed, int width,
+                                    char presentation, char sign, bool prefix ) -> fmt::format_context::iterator
+{
+  bool negative  = is_signed && static_cast<sc_dt::int64>( value ) < 0;
+  auto magnitude = negative ? ~value + 1 : value;
+  char text[72]; // "-0bsm" and up to 65 digits
+  char* p = text;
+  if ( presentation == 'd' ) {
+    if ( negative ) { *p++ = '-'; }
+    if ( prefix ) { *p++ = '0'; *p++ = 'd'; }
+    p = fmt::format_to( p, "{}", magnitude );
+    return std::copy( text, p, out );
+  }
+  int step = ( presentation == 'b' ) ? 1 : ( presentation == 'o' ) ? 3 : 4;
+  int msb = width - 1;
+  bool above = negative; // Value of the bits above bit 63
+  switch ( sign ) {
+    case 'u':
+      if ( negative ) { return fmt::format_to( out, "negative" ); }
+      if ( is_signed && width > 1 ) { --msb; } // Sign bit not shown
+      break;
+    case 'm':
+      if ( negative ) {
+        *p++ = '-';
+        value = magnitude;
+        above = false;
+      }
+      break;
+    default:
+      if ( !is_signed ) { ++msb; } // Leading 0 bit keeps the value positive
+      break;
+  }
+  if ( prefix ) {
+    *p++ = '0';
+    *p++ = presentation;
+    if ( sign == 'u' ) { *p++ = 'u'; *p++ = 's'; }
+    if ( sign == 'm' ) { *p++ = 's'; *p++ = 'm'; }
+  }
+  // Whole digits down to bit 0
+  for ( int low = ( msb + step ) / step * step - step; low >= 0; low -= step ) {
+    unsigned bits = ( low < 64 ) ? unsigned( value >> low ) : 0u;
+    if ( above && low + step > 64 ) { bits |= ~0u << ( low < 64 ? 64 - low : 0 ); }
+    *p++ = "0123456789abcdef"[bits & ( ( 1u << step ) - 1 )];
+  }
+  return std::copy( text, p, out );
+}
+
+SC_FORMAT_INLINE
+auto sc_format::detail::to_string_mutex() -> std::mutex&
+{
+  static std::mutex mutex;
+  return mutex;
+}
+#endif
 
 //------------------------------------------------------------------------------
 template< int W > // Custom formatter for sc_dt::sc_int<W>
@@ -74,49 +192,27 @@ struct fmt::formatter<sc_dt::sc_int<W>> : fmt::formatter<std::string> {
     return it;
   }
 
-  auto format( const sc_dt::sc_int<W>& data, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    using namespace sc_dt;
-    switch ( presentation ) {
-      case 'd':
-        return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
-      case 'b': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
-        }
-      }
-      case 'o': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
-        }
-      }
-      case 'x': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
-        }
-      }
-      case 'c':
-        return format_to( ctx.out(), "{}", data.to_string( SC_CSD, prefix ) );
-      default:
-        return format_to( ctx.out(), "Formatting error to sc_int" );
+  auto format( const sc_dt::sc_int<W>& data, format_context& ctx ) const -> decltype( ctx.out() );
+};
+
+template< int W >
+auto fmt::formatter<sc_dt::sc_int<W>>::format( const sc_dt::sc_int<W>& data, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  using namespace sc_dt;
+  switch ( presentation ) {
+    case 'd':
+    case 'b':
+    case 'o':
+    case 'x':
+      return sc_format::detail::format_int( ctx.out(), static_cast<uint64>( data.to_int64() ), true, W, presentation, sign, prefix );
+    case 'c': {
+      std::lock_guard<std::mutex> lock( sc_format::detail::to_string_mutex() );
+      return format_to( ctx.out(), "{}", data.to_string( SC_CSD, prefix ) );
     }
+    default:
+      return format_to( ctx.out(), "Formatting error to sc_int" );
   }
-};
+}
 
 //------------------------------------------------------------------------------
 template< int W > // Custom formatter for sc_dt::sc_uint<W>
@@ -138,48 +234,23 @@ struct fmt::formatter<sc_dt::sc_uint<W>> : fmt::formatter<std::string> {
     return it;
   }
 
-  auto format( const sc_dt::sc_uint<W>& data, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    using namespace sc_dt;
-    switch ( presentation ) {
-      case 'd':
-        return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
-      case 'b': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
-        }
-      }
-      case 'o': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
-        }
-      }
-      case 'x': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
-        }
-      }
-      default:
-        return format_to( ctx.out(), "Formatting error to sc_uint" );
-    }
-  }
+  auto format( const sc_dt::sc_uint<W>& data, format_context& ctx ) const -> decltype( ctx.out() );
 };
 
+template< int W >
+auto fmt::formatter<sc_dt::sc_uint<W>>::format( const sc_dt::sc_uint<W>& data, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  switch ( presentation ) {
+    case 'd':
+    case 'b':
+    case 'o':
+    case 'x':
+      return sc_format::detail::format_int( ctx.out(), data.to_uint64(), false, W, presentation, sign, prefix );
+    default:
+      return format_to( ctx.out(), "Formatting error to sc_uint" );
+  }
+}
+
 //------------------------------------------------------------------------------
 template< int W > // Custom formatter for sc_dt::sc_bigint<W>
 struct fmt::formatter<sc_dt::sc_bigint<W>> : fmt::formatter<std::string> {
@@ -200,47 +271,50 @@ struct fmt::formatter<sc_dt::sc_bigint<W>> : fmt::formatter<std::string> {
     return it;
   }
 
-  auto format( const sc_dt::sc_bigint<W>& data, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    using namespace sc_dt;
-    switch ( presentation ) {
-      case 'd':
-        return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
-      case 'b': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
-        }
+  auto format( const sc_dt::sc_bigint<W>& data, format_context& ctx ) const -> decltype( ctx.out() );
+};
+
+template< int W >
+auto fmt::formatter<sc_dt::sc_bigint<W>>::format( const sc_dt::sc_bigint<W>& data, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  using namespace sc_dt;
+  switch ( presentation ) {
+    case 'd':
+      return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
+    case 'b': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
       }
-      case 'o': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
-        }
+    }
+    case 'o': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
       }
-      case 'x': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
-        }
+    }
+    case 'x': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
       }
-      default:
-        return format_to( ctx.out(), "Formatting error to sc_bigint<W>" );
     }
+    default:
+      return format_to( ctx.out(), "Formatting error to sc_bigint<W>" );
   }
-};
+}
 
 //------------------------------------------------------------------------------
 template< int W > // Custom formatter for sc_dt::sc_biguint<W>
@@ -262,47 +336,50 @@ struct fmt::formatter<sc_dt::sc_biguint<W>> : fmt::formatter<std::string> {
     return it;
   }
 
-  auto format( const sc_dt::sc_biguint<W>& data, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    using namespace sc_dt;
-    switch ( presentation ) {
-      case 'd':
-        return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
-      case 'b': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
-        }
+  auto format( const sc_dt::sc_biguint<W>& data, format_context& ctx ) const -> decltype( ctx.out() );
+};
+
+template< int W >
+auto fmt::formatter<sc_dt::sc_biguint<W>>::format( const sc_dt::sc_biguint<W>& data, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  using namespace sc_dt;
+  switch ( presentation ) {
+    case 'd':
+      return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
+    case 'b': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
       }
-      case 'o': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
-        }
+    }
+    case 'o': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
       }
-      case 'x': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
-        }
+    }
+    case 'x': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
       }
-      default:
-        return format_to( ctx.out(), "Formatting error to sc_biguint<W>" );
     }
+    default:
+      return format_to( ctx.out(), "Formatting error to sc_biguint<W>" );
   }
-};
+}
 
 //------------------------------------------------------------------------------
 template< int W > // Custom formatter for sc_dt::sc_lv<W>
@@ -324,49 +401,54 @@ struct fmt::formatter<sc_dt::sc_lv<W>> : fmt::formatter<std::string> {
     return it;
   }
 
-  auto format( const sc_dt::sc_lv<W>& data, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    using namespace sc_dt;
-    switch ( presentation ) {
-      case 'l':
-        return format_to( ctx.out(), "{}", data.to_string() );
-      case 'd':
-        return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
-      case 'b': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
-        }
+  auto format( const sc_dt::sc_lv<W>& data, format_context& ctx ) const -> decltype( ctx.out() );
+};
+
+template< int W >
+auto fmt::formatter<sc_dt::sc_lv<W>>::format( const sc_dt::sc_lv<W>& data, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  using namespace sc_dt;
+  if ( presentation == 'l' ) { // Reads the bits only
+    return format_to( ctx.out(), "{}", data.to_string() );
+  }
+  std::lock_guard<std::mutex> lock( sc_format::detail::to_string_mutex() );
+  switch ( presentation ) {
+    case 'd':
+      return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
+    case 'b': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
       }
-      case 'o': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
-        }
+    }
+    case 'o': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
       }
-      case 'x': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
-        }
+    }
+    case 'x': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
       }
-      default:
-        return format_to( ctx.out(), "Formatting error to sc_lv<W>" );
     }
+    default:
+      return format_to( ctx.out(), "Formatting error to sc_lv<W>" );
   }
-};
+}
 
 //------------------------------------------------------------------------------
 template<> // Custom formatter for sc_dt::sc_logic
@@ -381,16 +463,21 @@ struct fmt::formatter<sc_dt::sc_logic> : fmt::formatter<std::string> {
     return it;
   }
 
-  auto format( const sc_dt::sc_logic& data, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    if ( presentation == 'l' ) {
-      return format_to( ctx.out(), "{}", data.to_char() );
-    } else {
-      return format_to( ctx.out(), "Formatting error to sc_logic" );
-    }
-  }
+  auto format( const sc_dt::sc_logic& data, format_context& ctx ) const -> decltype( ctx.out() );
 };
 
+#if defined( SC_FORMAT_HEADER_ONLY ) || defined( SC_FORMAT_IMPLEMENTATION )
+SC_FORMAT_INLINE
+auto fmt::formatter<sc_dt::sc_logic>::format( const sc_dt::sc_logic& data, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  if ( presentation == 'l' ) {
+    return format_to( ctx.out(), "{}", data.to_char() );
+  } else {
+    return format_to( ctx.out(), "Formatting error to sc_logic" );
+  }
+}
+#endif
+
 //------------------------------------------------------------------------------
 template<> // Custom formatter for sc_dt::sc_fix
 struct fmt::formatter<sc_dt::sc_fix> : fmt::formatter<std::string> {
@@ -410,51 +497,56 @@ struct fmt::formatter<sc_dt::sc_fix> : fmt::formatter<std::string> {
     return it;
   }
 
-  auto format( const sc_dt::sc_fix& data, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    using namespace sc_dt;
-    switch ( presentation ) {
-      case 'd':
-        return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
-      case 'e':
-        return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_E ) );
-      case 'f':
-        return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_F ) );
-      case 'b': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
-        }
+  auto format( const sc_dt::sc_fix& data, format_context& ctx ) const -> decltype( ctx.out() );
+};
+
+#if defined( SC_FORMAT_HEADER_ONLY ) || defined( SC_FORMAT_IMPLEMENTATION )
+SC_FORMAT_INLINE
+auto fmt::formatter<sc_dt::sc_fix>::format( const sc_dt::sc_fix& data, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  using namespace sc_dt;
+  switch ( presentation ) {
+    case 'd':
+      return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
+    case 'e':
+      return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_E ) );
+    case 'f':
+      return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_F ) );
+    case 'b': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
       }
-      case 'o': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
-        }
+    }
+    case 'o': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
       }
-      case 'x': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
-        }
+    }
+    case 'x': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
       }
-      default:
-        return format_to( ctx.out(), "Formatting error to sc_fix" );
     }
+    default:
+      return format_to( ctx.out(), "Formatting error to sc_fix" );
   }
-};
+}
+#endif
 
 //------------------------------------------------------------------------------
 template<> // Custom formatter for sc_dt::sc_ufix
@@ -476,51 +568,56 @@ struct fmt::formatter<sc_dt::sc_ufix> : fmt::formatter<std::string> {
     return it;
   }
 
-  auto format( const sc_dt::sc_ufix& data, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    using namespace sc_dt;
-    switch ( presentation ) {
-      case 'e':
-        return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_E ) );
-      case 'f':
-        return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_F ) );
-      case 'd':
-        return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
-      case 'b': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
-        }
+  auto format( const sc_dt::sc_ufix& data, format_context& ctx ) const -> decltype( ctx.out() );
+};
+
+#if defined( SC_FORMAT_HEADER_ONLY ) || defined( SC_FORMAT_IMPLEMENTATION )
+SC_FORMAT_INLINE
+auto fmt::formatter<sc_dt::sc_ufix>::format( const sc_dt::sc_ufix& data, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  using namespace sc_dt;
+  switch ( presentation ) {
+    case 'e':
+      return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_E ) );
+    case 'f':
+      return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_F ) );
+    case 'd':
+      return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
+    case 'b': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
       }
-      case 'o': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
-        }
+    }
+    case 'o': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
       }
-      case 'x': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
-        }
+    }
+    case 'x': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
       }
-      default:
-        return format_to( ctx.out(), "Formatting error to sc_ufix" );
     }
+    default:
+      return format_to( ctx.out(), "Formatting error to sc_ufix" );
   }
-};
+}
+#endif
 
 //------------------------------------------------------------------------------
 template< int WL, int IL, sc_dt::sc_q_mode Q, sc_dt::sc_o_mode O, int N > // Custom formatter for sc_dt::sc_fix
@@ -542,51 +639,54 @@ struct fmt::formatter<sc_dt::sc_fixed<WL, IL, Q, O, N>> : fmt::formatter<std::st
     return it;
   }
 
-  auto format( const sc_dt::sc_fixed<WL, IL, Q, O, N>& data, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    using namespace sc_dt;
-    switch ( presentation ) {
-      case 'd':
-        return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
-      case 'e':
-        return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_E ) );
-      case 'f':
-        return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_F ) );
-      case 'b': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
-        }
+  auto format( const sc_dt::sc_fixed<WL, IL, Q, O, N>& data, format_context& ctx ) const -> decltype( ctx.out() );
+};
+
+template< int WL, int IL, sc_dt::sc_q_mode Q, sc_dt::sc_o_mode O, int N >
+auto fmt::formatter<sc_dt::sc_fixed<WL, IL, Q, O, N>>::format( const sc_dt::sc_fixed<WL, IL, Q, O, N>& data, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  using namespace sc_dt;
+  switch ( presentation ) {
+    case 'd':
+      return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
+    case 'e':
+      return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_E ) );
+    case 'f':
+      return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_F ) );
+    case 'b': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
       }
-      case 'o': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
-        }
+    }
+    case 'o': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
       }
-      case 'x': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
-        }
+    }
+    case 'x': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
       }
-      default:
-        return format_to( ctx.out(), "Formatting error to sc_fix" );
     }
+    default:
+      return format_to( ctx.out(), "Formatting error to sc_fix" );
   }
-};
+}
 
 //------------------------------------------------------------------------------
 template< int WL, int IL, sc_dt::sc_q_mode Q, sc_dt::sc_o_mode O, int N > // Custom formatter for sc_dt::sc_fix
@@ -608,51 +708,71 @@ struct fmt::formatter<sc_dt::sc_ufixed<WL, IL, Q, O, N>> : fmt::formatter<std::s
     return it;
   }
 
-  auto format( const sc_dt::sc_ufixed<WL, IL, Q, O, N>& data, format_context& ctx ) const -> decltype( ctx.out() )
-  {
-    using namespace sc_dt;
-    switch ( presentation ) {
-      case 'e':
-        return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_E ) );
-      case 'f':
-        return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_F ) );
-      case 'd':
-        return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
-      case 'b': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
-        }
+  auto format( const sc_dt::sc_ufixed<WL, IL, Q, O, N>& data, format_context& ctx ) const -> decltype( ctx.out() );
+};
+
+template< int WL, int IL, sc_dt::sc_q_mode Q, sc_dt::sc_o_mode O, int N >
+auto fmt::formatter<sc_dt::sc_ufixed<WL, IL, Q, O, N>>::format( const sc_dt::sc_ufixed<WL, IL, Q, O, N>& data, format_context& ctx ) const -> decltype( ctx.out() )
+{
+  using namespace sc_dt;
+  switch ( presentation ) {
+    case 'e':
+      return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_E ) );
+    case 'f':
+      return format_to( ctx.out(), "{}", data.to_string( SC_BIN, false, SC_F ) );
+    case 'd':
+      return format_to( ctx.out(), "{}", data.to_string( SC_DEC, prefix ) );
+    case 'b': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_BIN, prefix ) );
       }
-      case 'o': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
-        }
+    }
+    case 'o': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_OCT, prefix ) );
       }
-      case 'x': {
-        switch ( sign ) {
-          case 'm':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
-          case 'u':
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
-          default:
-            return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
-        }
+    }
+    case 'x': {
+      switch ( sign ) {
+        case 'm':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_SM, prefix ) );
+        case 'u':
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX_US, prefix ) );
+        default:
+          return format_to( ctx.out(), "{}", data.to_string( SC_HEX, prefix ) );
       }
-      default:
-        return format_to( ctx.out(), "Formatting error to sc_ufix" );
     }
+    default:
+      return format_to( ctx.out(), "Formatting error to sc_ufix" );
   }
-};
+}
+
+//------------------------------------------------------------------------------
+// Widths compiled once into the sc_format library (sc_int/sc_uint stop at 64)
+#define SC_FORMAT_INT_WIDTHS( X, T ) X( T, 8 ) X( T, 16 ) X( T, 32 ) X( T, 64 )
+#define SC_FORMAT_BIG_WIDTHS( X, T ) SC_FORMAT_INT_WIDTHS( X, T ) X( T, 128 ) X( T, 256 ) X( T, 512 )
+#define SC_FORMAT_ALL_WIDTHS( X ) \
+  SC_FORMAT_INT_WIDTHS( X, sc_int ) \
+  SC_FORMAT_INT_WIDTHS( X, sc_uint ) \
+  SC_FORMAT_BIG_WIDTHS( X, sc_bigint ) \
+  SC_FORMAT_BIG_WIDTHS( X, sc_biguint ) \
+  SC_FORMAT_BIG_WIDTHS( X, sc_lv )
+
+#if !defined( SC_FORMAT_HEADER_ONLY ) && !defined( SC_FORMAT_IMPLEMENTATION )
+#  define SC_FORMAT_EXTERN( T, W ) extern template struct fmt::formatter<sc_dt::T<W>>;
+SC_FORMAT_ALL_WIDTHS( SC_FORMAT_EXTERN )
+#  undef SC_FORMAT_EXTERN
+#endif
 
 // TAGS: Doulos, Systemc, format, SOURCE
 // ----------------------------------------------------------------------------
@@ -0,0 +1,185 @@
+#pragma once
+
+// Bulk formatting of contiguous ranges (memory dumps, register banks).
+//
+// + sc_format::format_range( out, "{:x}\n", data, count[, options] )
+//   appends every element formatted with the given spec to one buffer. Large
+//   ranges are split into contiguous chunks, each formatted by a worker thread
+//   into its own buffer; the chunks are then appended in order, so the result
+//   is identical to a simple loop.
+// + sc_format::write_range( fd, "{:x}\n", data, count[, options] )
+//   streams the same output to a file descriptor in blocks, so memory stays
+//   bounded by threads * block elements regardless of the range size.
+//
+// Both accept any type with a formatter (see sc_format.hpp), and container
+// overloads take anything with std::data()/std::size().
+//
+// Only types for which bulk_parallel_safe<T> holds are split across threads.
+// sc_int<W>, sc_uint<W> and sc_lv<W> are formatted in parallel: their
+// formatters render natively or only read bits, and hold a lock around the
+// few forms that still call to_string() (see "Thread safety" in
+// sc_format.hpp; sc_lv's numeric forms are therefore correct but gain little
+// from threads). It is false for sc_bigint, sc_biguint, the fixed-point types
+// and sc_time, whose formatters call to_string() unlocked: it builds
+// sc_fix/sc_ufix temporaries from SystemC's unlocked free lists and reads
+// kernel globals, so concurrent use is a data race on stock SystemC builds.
+// Those ranges are always formatted on the calling thread, whatever
+// BulkOptions::threads says (write_range still streams in blocks). Specialize
+// bulk_parallel_safe for your own types as needed.
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <unistd.h>
+#include <fmt/format.h>
+#include "sc_format_fwd.hpp"
+
+namespace sc_format {
+
+// May T's formatter run on several threads at once?
+template< typename T >   struct bulk_parallel_safe                        : std::true_type {};
+template< int W >        struct bulk_parallel_safe<sc_dt::sc_bigint<W>>   : std::false_type {};
+template< int W >        struct bulk_parallel_safe<sc_dt::sc_biguint<W>>  : std::false_type {};
+template<>               struct bulk_parallel_safe<sc_dt::sc_fix>         : std::false_type {};
+template<>               struct bulk_parallel_safe<sc_dt::sc_ufix>        : std::false_type {};
+template<>               struct bulk_parallel_safe<sc_core::sc_time>      : std::false_type {};
+
+template< typename T > // sc_fixed<>/sc_ufixed<> derive from sc_fix/sc_ufix
+constexpr bool bulk_parallel_safe_v = bulk_parallel_safe<T>::value
+                                   && !std::is_base_of_v<sc_dt::sc_fix, T>
+                                   && !std::is_base_of_v<sc_dt::sc_ufix, T>;
+
+struct BulkOptions {
+  unsigned    threads{ 0 };       // 0 -> std::thread::hardware_concurrency(); ignored unless bulk_parallel_safe_v<T>
+  std::size_t min_chunk{ 4096 };  // Ranges smaller than this per thread are not split
+  std::size_t block{ 1u << 16 };  // Elements per worker per write (write_range only)
+};
+
+namespace detail {
+
+template< typename T >
+auto thread_count( BulkOptions const& options, std::size_t count ) -> std::size_t
+{
+  if constexpr ( !bulk_parallel_safe_v<T> ) { return 1; }
+  std::size_t threads = options.threads ? options.threads : std::max( 1u, std::thread::hardware_concurrency() );
+  std::size_t useful  = std::max<std::size_t>( 1, count / std::max<std::size_t>( 1, options.min_chunk ) );
+  return std::min( threads, useful );
+}
+
+template< typename T >
+void format_serial( fmt::memory_buffer& out, fmt::format_string<const T&> spec, const T* data, std::size_t count )
+{
+  auto it = std::back_inserter( out );
+  for ( std::size_t i = 0; i < count; ++i ) {
+    it = fmt::format_to( it, spec, data[i] );
+  }
+}
+
+// Format data[0..count) as `parts.size()` contiguous chunks in parallel;
+// parts[i] receives chunk i (previous contents are discarded)
+template< typename T >
+void format_chunks( std::vector<fmt::memory_buffer>& parts, fmt::format_string<const T&> spec, const T* data, std::size_t count )
+{
+  auto chunks = parts.size();
+  std::vector<std::exception_ptr> errors( chunks );
+  auto work = [&]( std::size_t i ) {
+    try {
+      auto first = count * i / chunks;
+      auto last  = count * ( i + 1 ) / chunks;
+      parts[i].clear();
+      format_serial( parts[i], spec, data + first, last - first );
+    } catch ( ... ) {
+      errors[i] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  try {
+    workers.reserve( chunks - 1 );
+    for ( std::size_t i = 1; i < chunks; ++i ) { workers.emplace_back( work, i ); }
+  } catch ( ... ) {
+    // Could not start every worker: wait for those that did before unwinding
+    for ( auto& worker : workers ) { worker.join(); }
+    throw;
+  }
+  work( 0 ); // Calling thread takes the first chunk
+  for ( auto& worker : workers ) { worker.join(); }
+  for ( auto& error : errors ) {
+    if ( error ) { std::rethrow_exception( error ); }
+  }
+}
+
+inline void write_all( int fd, const char* data, std::size_t size )
+{
+  while ( size > 0 ) {
+    auto written = ::write( fd, data, size );
+    if ( written < 0 ) {
+      if ( errno == EINTR ) { continue; }
+      throw std::system_error( errno, std::generic_category(), "sc_format::write_range" );
+    }
+    data += written;
+    size -= static_cast<std::size_t>( written );
+  }
+}
+
+}//end namespace detail
+
+//------------------------------------------------------------------------------
+template< typename T >
+void format_range( fmt::memory_buffer& out, fmt::format_string<const T&> spec, const T* data, std::size_t count, BulkOptions const& options = {} )
+{
+  auto threads = detail::thread_count<T>( options, count );
+  if ( threads <= 1 ) {
+    detail::format_serial( out, spec, data, count );
+    return;
+  }
+  std::vector<fmt::memory_buffer> parts( threads );
+  detail::format_chunks( parts, spec, data, count );
+  for ( auto const& part : parts ) { out.append( part.data(), part.data() + part.size() ); }
+}
+
+template< typename Container >
+void format_range( fmt::memory_buffer& out, fmt::format_string<const typename Container::value_type&> spec, Container const& values, BulkOptions const& options = {} )
+{
+  format_range( out, spec, std::data( values ), std::size( values ), options );
+}
+
+//------------------------------------------------------------------------------
+template< typename T >
+void write_range( int fd, fmt::format_string<const T&> spec, const T* data, std::size_t count, BulkOptions const& options = {} )
+{
+  auto block   = std::max<std::size_t>( 1, options.block );
+  auto threads = detail::thread_count<T>( options, count );
+  std::vector<fmt::memory_buffer> parts( threads ); // Reused for every round
+  for ( std::size_t done = 0; done < count; ) {
+    auto round = std::min( count - done, block * threads );
+    if ( threads <= 1 ) {
+      parts[0].clear();
+      detail::format_serial( parts[0], spec, data + done, round );
+    } else {
+      detail::format_chunks( parts, spec, data + done, round );
+    }
+    for ( auto const& part : parts ) { detail::write_all( fd, part.data(), part.size() ); }
+    done += round;
+  }
+}
+
+template< typename Container >
+void write_range( int fd, fmt::format_string<const typename Container::value_type&> spec, Container const& values, BulkOptions const& options = {} )
+{
+  write_range( fd, spec, std::data( values ), std::size( values ), options );
+}
+
+}//end namespace sc_format
+
+// TAGS: Doulos, Systemc, format, bulk, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
@@ -0,0 +1,47 @@
+#pragma once
+
+// Lightweight forward declarations for sc_format.hpp.
+//
+// Declares the SystemC types and the fmt::formatter specializations provided
+// by sc_format.hpp without pulling in <systemc> or <fmt/format.h>. Use it in
+// headers that only pass these values around or declare functions taking
+// them; include sc_format.hpp in the translation units that actually format.
+// Formatting a type whose formatter is only declared here is a compile error
+// rather than a silent fallback to another formatter.
+//
+// sc_fixed<>/sc_ufixed<> are not declared here because their template
+// parameters use SystemC enums that cannot be forward declared.
+
+#include <fmt/core.h>
+
+namespace sc_core {
+class sc_time;
+}
+
+namespace sc_dt {
+template< int W > class sc_int;
+template< int W > class sc_uint;
+template< int W > class sc_bigint;
+template< int W > class sc_biguint;
+template< int W > class sc_lv;
+class sc_logic;
+class sc_fix;
+class sc_ufix;
+}
+
+template<>        struct fmt::formatter<sc_core::sc_time>;
+template< int W > struct fmt::formatter<sc_dt::sc_int<W>>;
+template< int W > struct fmt::formatter<sc_dt::sc_uint<W>>;
+template< int W > struct fmt::formatter<sc_dt::sc_bigint<W>>;
+template< int W > struct fmt::formatter<sc_dt::sc_biguint<W>>;
+template< int W > struct fmt::formatter<sc_dt::sc_lv<W>>;
+template<>        struct fmt::formatter<sc_dt::sc_logic>;
+template<>        struct fmt::formatter<sc_dt::sc_fix>;
+template<>        struct fmt::formatter<sc_dt::sc_ufix>;
+
+// TAGS: Doulos, Systemc, format, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
@@ -0,0 +1,51 @@
+#pragma once
+
+// Cached rendering of the current simulation time.
+//
+// TimeCache::current() returns the raw ticks and pre-rendered text of
+// sc_time_stamp(). The text is rebuilt only when the kernel has advanced
+// time since the last call, so thousands of reports issued within one time
+// step pay for a single sc_time::to_string(). Checking for a time advance is
+// one integer compare against the kernel's current time.
+//
+// The sc_time formatter in sc_format.hpp uses the cache whenever it is asked
+// to format the current time (other times go straight to to_string()), e.g.
+//   REPORT_INFO( "{} sending {}", sc_time_stamp(), v );
+//
+// Each OS thread has its own cache.
+
+#include <systemc>
+#include <string_view>
+#include <fmt/format.h>
+
+class TimeCache {
+public:
+  static auto current() -> TimeCache const&
+  {
+    thread_local TimeCache cache;
+    cache.refresh( sc_core::sc_time_stamp() );
+    return cache;
+  }
+  auto ticks() const -> sc_dt::uint64    { return m_ticks; }
+  auto text()  const -> std::string_view { return { m_text.data(), m_text.size() }; }
+private:
+  void refresh( sc_core::sc_time const& now )
+  {
+    if( m_valid && now.value() == m_ticks ) return;
+    m_ticks = now.value();
+    m_text.clear();
+    auto text = now.to_string();
+    m_text.append( text.data(), text.data() + text.size() );
+    m_valid = true;
+  }
+  sc_dt::uint64      m_ticks{ 0 };
+  fmt::memory_buffer m_text;
+  bool               m_valid{ false };
+};
+
+// TAGS: Doulos, Systemc, format, time, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.
@@ -0,0 +1,69 @@
+// Cost of stamping reports with the current simulation time.
+//
+// Within each time step a thread formats the same message many times, once
+// with sc_time_stamp().to_string() (the pre-cache approach) and once through
+// the sc_time formatter, which renders the time only once per step via
+// TimeCache. Both write into a reused buffer so only time rendering differs.
+//
+// Usage: time_bench [reports-per-step [steps]]
+
+#include <systemc>
+#include <chrono>
+#include <cstdlib>
+#include <iterator>
+#include "sc_format.hpp"
+
+using namespace sc_core;
+
+SC_MODULE( Stamper ) {
+  explicit SC_CTOR( Stamper ) {
+    SC_THREAD( thread1 );
+  }
+  void thread1()
+  {
+    fmt::memory_buffer buf;
+    for( std::size_t step = 0; step < m_steps; ++step ) {
+      auto start = std::chrono::steady_clock::now();
+      for( std::size_t i = 0; i < m_reports; ++i ) {
+        buf.clear();
+        fmt::format_to( std::back_inserter( buf ), "{} transaction {}", sc_time_stamp().to_string(), i );
+      }
+      auto middle = std::chrono::steady_clock::now();
+      for( std::size_t i = 0; i < m_reports; ++i ) {
+        buf.clear();
+        fmt::format_to( std::back_inserter( buf ), "{} transaction {}", sc_time_stamp(), i );
+      }
+      auto end = std::chrono::steady_clock::now();
+      m_uncached += middle - start;
+      m_cached   += end - middle;
+      wait( 1, SC_NS );
+    }
+  }
+  std::size_t m_reports{ 5'000 };
+  std::size_t m_steps{ 1'000 };
+  std::chrono::duration<double> m_uncached{};
+  std::chrono::duration<double> m_cached{};
+};
+
+[[maybe_unused]]
+int sc_main( int argc, char* argv[] )
+{
+  Stamper SC_NAMED(stamper);
+  if( argc > 1 ) stamper.m_reports = std::strtoull( argv[1], nullptr, 0 );
+  if( argc > 2 ) stamper.m_steps   = std::strtoull( argv[2], nullptr, 0 );
+  sc_start();
+
+  auto total = double( stamper.m_reports * stamper.m_steps );
+  fmt::print( "{} reports per time step, {} time steps\n", stamper.m_reports, stamper.m_steps );
+  fmt::print( "{:<12} {:8.3f} s = {:>14.0f} reports/s\n", "to_string()", stamper.m_uncached.count(), total / stamper.m_uncached.count() );
+  fmt::print( "{:<12} {:8.3f} s = {:>14.0f} reports/s\n", "TimeCache", stamper.m_cached.count(), total / stamper.m_cached.count() );
+  fmt::print( "Speedup: {:.2f}x\n", stamper.m_uncached.count() / stamper.m_cached.count() );
+  return 0;
+}
+
+// TAGS: Doulos, Systemc, format, time, benchmark, SOURCE
+// ----------------------------------------------------------------------------
+//
+// This file is licensed under Apache-2.0, and
+// Copyright 2023 Doulos Inc. <mailto:info@doulos.com>
+// See accompanying LICENSE or visit <https://www.apache.org/licenses/LICENSE-2.0.txt> for more details.